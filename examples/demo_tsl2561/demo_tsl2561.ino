@@ -23,6 +23,7 @@ TSL2561 tsl(TSL2561_ADDR);
 
 // sensor related vars
 uint16_t integrationTime;
+uint8_t itSwitch = 1;
 double illuminance;
 uint32_t illuminance_int;
 bool autoGainOn;
@@ -88,7 +89,8 @@ void setup()
 
 void loop()
 {
-  uint16_t broadband, ir;
+  // raw data and exposure settings, lux is calculated on demand
+  TSL2561Sample sample;
 
   // update exposure settings display vars
   if (tsl._gain)
@@ -107,7 +109,7 @@ void loop()
     strcpy(tsl_status,"OK");
 
     // get raw data from sensor
-    if(!tsl.getData(broadband,ir,autoGainOn))
+    if(!tsl.getData(sample,autoGainOn))
     {
       error_code = tsl.getError();
       strcpy(tsl_status,"saturated?");
@@ -117,7 +119,7 @@ void loop()
 
 
     // compute illuminance value in lux
-    if(!tsl.getLux(integrationTime,broadband,ir,illuminance))
+    if(!sample.getLux(illuminance))
     {
       error_code = tsl.getError();
       strcpy(tsl_status,"getLuxError");
@@ -125,13 +127,17 @@ void loop()
     }
 
     // try the integer based calculation
-    if(!tsl.getLuxInt(broadband,ir,illuminance_int))
+    if(!sample.getLuxInt(illuminance_int))
     {
       error_code = tsl.getError();
       strcpy(tsl_status,"getLuxIntError");
       operational = false;
     }
 
+    // back to the saved integration time after a warm start
+    if (operational)
+      tsl.restoreTiming(integrationTime);
+
   }
   else
   // device not set correctly
@@ -142,13 +148,10 @@ void loop()
       // power down the sensor
       tsl.setPowerDown();
       delay(100);
-      // re-init the sensor
-      if (tsl.begin())
+      // re-init the sensor with the last settings, ID is checked again
+      // first integration is 14ms, integration time is restored after the next reading
+      if (tsl.warmStart(tsl._gain,itSwitch,integrationTime,false))
       {
-        // power up
-        tsl.setPowerUp();
-        // re-configure
-        tsl.setTiming(tsl._gain,1,integrationTime);
         // try to go back normal again
         operational = true;
       }
@@ -207,7 +210,8 @@ int setExposure(String command)
         return -1;
     }
     else {
-      // all is good
+      // all is good, keep the integration time for a warm start
+      itSwitch = itSwitchInput;
       operational = true;
       return 0;
     }
@@ -0,0 +1,263 @@
+/*
+	Exhaustive accuracy and speed sweep of the TSL2561 lux conversions (host tool)
+
+	Evaluates tsl2561_lux() (float) and tsl2561_luxInt() (integer) for every
+	(CH0, CH1) pair and every gain / integration time combination, on all cores.
+	For each combination it reports:
+	- how many pairs each path accepts (the saturation rules are not the same)
+	- the distribution of the integer result error relative to the float result
+	- the worst relative and absolute errors with their (CH0, CH1) pair
+	- the throughput of each conversion path
+
+	Build and run from the library root:
+	g++ -O2 -std=c++11 -pthread -Isrc extras/lux_sweep/lux_sweep.cpp src/tsl2561_lux.cpp -o lux_sweep
+	./lux_sweep [-s step] [-t threads] [-m min_lux]
+
+	-s step:    only evaluate every step-th CH0 and CH1 value (default 1: every pair)
+	-t threads: number of worker threads (default: number of cores)
+	-m min_lux: relative errors are only counted when the float result is at least
+	            min_lux (default 1.0), smaller values only count as absolute errors
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "tsl2561_lux.h"
+
+#if !TSL2561_WITH_FLOAT_LUX || !TSL2561_WITH_INT_LUX
+#error "lux_sweep needs both conversion paths (TSL2561_PROFILE_FULL)"
+#endif
+
+// Relative error histogram bucket limits (in %), last bucket is everything above
+static const double bucketLimits[] = {0.5, 1.0, 2.0, 5.0, 10.0};
+#define BUCKETS (sizeof(bucketLimits) / sizeof(bucketLimits[0]) + 1)
+
+struct SweepStats
+{
+	uint64_t pairs;
+	uint64_t bothValid;
+	uint64_t floatOnly;   // integer path rejected the pair (clipping threshold)
+	uint64_t intOnly;     // float path rejected the pair (0xFFFF)
+	uint64_t relCount;    // pairs with float lux >= min_lux
+	uint64_t buckets[BUCKETS];
+	double sumRel;
+	double worstRel;
+	uint16_t worstRelCH0, worstRelCH1;
+	double worstRelFloat;
+	uint32_t worstRelInt;
+	double worstAbs;
+	uint16_t worstAbsCH0, worstAbsCH1;
+	double worstAbsFloat;
+	uint32_t worstAbsInt;
+	double floatSeconds;
+	double intSeconds;
+
+	SweepStats() { clear(); }
+
+	void clear(void)
+	{
+		pairs = bothValid = floatOnly = intOnly = relCount = 0;
+		for (unsigned i = 0; i < BUCKETS; i++)
+			buckets[i] = 0;
+		sumRel = worstRel = worstAbs = 0.0;
+		worstRelCH0 = worstRelCH1 = worstAbsCH0 = worstAbsCH1 = 0;
+		worstRelFloat = worstAbsFloat = 0.0;
+		worstRelInt = worstAbsInt = 0;
+		floatSeconds = intSeconds = 0.0;
+	}
+
+	void merge(const SweepStats &other)
+	{
+		pairs += other.pairs;
+		bothValid += other.bothValid;
+		floatOnly += other.floatOnly;
+		intOnly += other.intOnly;
+		relCount += other.relCount;
+		for (unsigned i = 0; i < BUCKETS; i++)
+			buckets[i] += other.buckets[i];
+		sumRel += other.sumRel;
+		if (other.worstRel > worstRel)
+		{
+			worstRel = other.worstRel;
+			worstRelCH0 = other.worstRelCH0;
+			worstRelCH1 = other.worstRelCH1;
+			worstRelFloat = other.worstRelFloat;
+			worstRelInt = other.worstRelInt;
+		}
+		if (other.worstAbs > worstAbs)
+		{
+			worstAbs = other.worstAbs;
+			worstAbsCH0 = other.worstAbsCH0;
+			worstAbsCH1 = other.worstAbsCH1;
+			worstAbsFloat = other.worstAbsFloat;
+			worstAbsInt = other.worstAbsInt;
+		}
+		floatSeconds += other.floatSeconds;
+		intSeconds += other.intSeconds;
+	}
+};
+
+struct SweepJob
+{
+	bool gain;
+	uint8_t it;
+	uint16_t ms;
+	unsigned step;
+	double minLux;
+	std::atomic<unsigned> nextRow;
+};
+
+static void sweepRows(SweepJob *job, SweepStats *stats)
+// Worker: takes CH0 rows from the job until none is left
+{
+	typedef std::chrono::steady_clock clk;
+	std::vector<double> luxF;
+	std::vector<uint32_t> luxI;
+	std::vector<uint8_t> okF, okI;
+	unsigned n = 0;
+
+	for (unsigned ch1 = 0; ch1 <= 0xFFFF; ch1 += job->step)
+		n++;
+	luxF.resize(n); luxI.resize(n);
+	okF.resize(n); okI.resize(n);
+
+	for (;;)
+	{
+		unsigned ch0 = job->nextRow.fetch_add(job->step);
+		if (ch0 > 0xFFFF)
+			break;
+
+		// float path over the whole row
+		clk::time_point t0 = clk::now();
+		for (unsigned i = 0, ch1 = 0; i < n; i++, ch1 += job->step)
+			okF[i] = tsl2561_lux(job->gain, job->ms, ch0, ch1, luxF[i]);
+		clk::time_point t1 = clk::now();
+		// integer path over the whole row
+		for (unsigned i = 0, ch1 = 0; i < n; i++, ch1 += job->step)
+			okI[i] = tsl2561_luxInt(job->gain, job->it, ch0, ch1, luxI[i]);
+		clk::time_point t2 = clk::now();
+
+		stats->floatSeconds += std::chrono::duration<double>(t1 - t0).count();
+		stats->intSeconds += std::chrono::duration<double>(t2 - t1).count();
+		stats->pairs += n;
+
+		// compare
+		for (unsigned i = 0, ch1 = 0; i < n; i++, ch1 += job->step)
+		{
+			if (okF[i] && !okI[i]) { stats->floatOnly++; continue; }
+			if (!okF[i] && okI[i]) { stats->intOnly++; continue; }
+			if (!okF[i]) continue;
+			stats->bothValid++;
+
+			double absErr = fabs((double)luxI[i] - luxF[i]);
+			if (absErr > stats->worstAbs)
+			{
+				stats->worstAbs = absErr;
+				stats->worstAbsCH0 = ch0;
+				stats->worstAbsCH1 = ch1;
+				stats->worstAbsFloat = luxF[i];
+				stats->worstAbsInt = luxI[i];
+			}
+
+			if (luxF[i] < job->minLux)
+				continue;
+			double rel = 100.0 * absErr / luxF[i];
+			unsigned b = 0;
+			while (b < BUCKETS - 1 && rel > bucketLimits[b])
+				b++;
+			stats->buckets[b]++;
+			stats->relCount++;
+			stats->sumRel += rel;
+			if (rel > stats->worstRel)
+			{
+				stats->worstRel = rel;
+				stats->worstRelCH0 = ch0;
+				stats->worstRelCH1 = ch1;
+				stats->worstRelFloat = luxF[i];
+				stats->worstRelInt = luxI[i];
+			}
+		}
+	}
+}
+
+static void printStats(bool gain, uint16_t ms, const SweepStats &s, double wall)
+{
+	printf("gain x%-2d %3d ms: %llu pairs in %.1f s\n", gain ? 16 : 1, ms,
+		(unsigned long long)s.pairs, wall);
+	printf("  accepted by both: %llu, float only: %llu, integer only: %llu\n",
+		(unsigned long long)s.bothValid, (unsigned long long)s.floatOnly,
+		(unsigned long long)s.intOnly);
+	printf("  relative error (%llu pairs):", (unsigned long long)s.relCount);
+	for (unsigned i = 0; i < BUCKETS; i++)
+	{
+		double pct = s.relCount ? 100.0 * s.buckets[i] / s.relCount : 0.0;
+		if (i < BUCKETS - 1)
+			printf(" <=%.1f%%: %.2f%%", bucketLimits[i], pct);
+		else
+			printf(" >%.1f%%: %.2f%%", bucketLimits[i - 1], pct);
+	}
+	printf("\n  mean %.3f%%, worst %.3f%% at CH0=%u CH1=%u (float %.3f, int %u)\n",
+		s.relCount ? s.sumRel / s.relCount : 0.0, s.worstRel,
+		s.worstRelCH0, s.worstRelCH1, s.worstRelFloat, s.worstRelInt);
+	printf("  worst absolute error %.3f lux at CH0=%u CH1=%u (float %.3f, int %u)\n",
+		s.worstAbs, s.worstAbsCH0, s.worstAbsCH1, s.worstAbsFloat, s.worstAbsInt);
+	printf("  throughput per core: float %.1f Mpairs/s, int %.1f Mpairs/s\n",
+		s.floatSeconds > 0 ? s.pairs / s.floatSeconds / 1e6 : 0.0,
+		s.intSeconds > 0 ? s.pairs / s.intSeconds / 1e6 : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+	unsigned step = 1;
+	unsigned threads = std::thread::hardware_concurrency();
+	double minLux = 1.0;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (argv[i][0] == '-' && argv[i][1] == 's') step = atoi(argv[i + 1]);
+		else if (argv[i][0] == '-' && argv[i][1] == 't') threads = atoi(argv[i + 1]);
+		else if (argv[i][0] == '-' && argv[i][1] == 'm') minLux = atof(argv[i + 1]);
+	}
+	if (step < 1) step = 1;
+	if (threads < 1) threads = 1;
+
+	// integration time in ms for each switch value, as returned by setTiming()
+	static const uint16_t itMs[] = {14, 101, 402};
+
+	printf("TSL2561 lux conversion sweep: step %u, %u threads, min lux %.2f\n",
+		step, threads, minLux);
+
+	for (int g = 0; g < 2; g++)
+	{
+		for (uint8_t it = 0; it < 3; it++)
+		{
+			SweepJob job;
+			job.gain = g;
+			job.it = it;
+			job.ms = itMs[it];
+			job.step = step;
+			job.minLux = minLux;
+			job.nextRow = 0;
+
+			std::vector<SweepStats> stats(threads);
+			std::vector<std::thread> workers;
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (unsigned t = 0; t < threads; t++)
+				workers.push_back(std::thread(sweepRows, &job, &stats[t]));
+			for (unsigned t = 0; t < threads; t++)
+				workers[t].join();
+			double wall = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+
+			SweepStats total;
+			for (unsigned t = 0; t < threads; t++)
+				total.merge(stats[t]);
+			printStats(g, job.ms, total, wall);
+		}
+	}
+	return 0;
+}
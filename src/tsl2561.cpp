@@ -17,21 +17,65 @@
 */
 
 #include "tsl2561.h"
-#include "math.h" //needed to use pow(x,a)
+
+
+// integration time in ms for an integration time switch value (0 for manual)
+static uint16_t integrationMs(uint8_t it_switch)
+{
+	switch (it_switch)
+	{
+		case 0: return(14);
+		case 1: return(101);
+		case 2: return(402);
+		default: return(0);
+	}
+}
 
 
 TSL2561::TSL2561(uint8_t i2c_address){
 	_i2c_address = i2c_address;
+	_wire = &Wire; // default I2C bus
+	_gain = false; //default gain x1
+	_it = 1; // default integration time = 101 ms
+	_firstSample = false;
+	_startTime = 0;
+	_powerUpTime = 0;
+	_poweredUp = false;
+	_startupLatency = 0;
+	_warmIt = TSL2561_NO_WARM_IT;
+	_dataGain = _gain;
+	_dataIt = _it;
+	_timingTime = 0;
+}
+
+
+TSL2561::TSL2561(uint8_t i2c_address, TwoWire &wire){
+	_i2c_address = i2c_address;
+	_wire = &wire;
 	_gain = false; //default gain x1
 	_it = 1; // default integration time = 101 ms
+	_firstSample = false;
+	_startTime = 0;
+	_powerUpTime = 0;
+	_poweredUp = false;
+	_startupLatency = 0;
+	_warmIt = TSL2561_NO_WARM_IT;
+	_dataGain = _gain;
+	_dataIt = _it;
+	_timingTime = 0;
 }
 
 
 boolean TSL2561::begin(void)
 {
 	uint8_t ID;
-	// start I2C
-	Wire.begin();
+	// start the boot to first sample timer, a power up is needed before a valid sample
+	_startTime = millis();
+	_firstSample = true;
+	_powerUpTime = 0;
+	_poweredUp = false;
+	// start I2C on the bus this sensor is bound to
+	_wire->begin();
 	// read device ID
 	if (readByte(TSL2561_REG_ID,ID) && ID==0x50)
 	{
@@ -44,10 +88,105 @@ boolean TSL2561::begin(void)
 }
 
 
+boolean TSL2561::warmStart(boolean gain, uint8_t it_switch, uint16_t &ms, boolean verified)
+	// Fast bring-up of a device with saved gain and integration time settings
+	// If verified = true, the device ID check is skipped
+	// First integration is 13.7ms (ms = 14), the saved integration time is
+	// written by restoreTiming() once the first sample is read
+	// Returns true (1) if successful, false (0) if there was an I2C error or a wrong ID
+	// (Also see getError() below)
+{
+	// configure, then power up last: begin integration
+	if (warmConfigure(gain,it_switch,ms,verified))
+		return(setPowerUp());
+
+	return(false);
+}
+
+#if TSL2561_WITH_INTERRUPTS
+boolean TSL2561::warmStart(boolean gain, uint8_t it_switch, uint16_t &ms, boolean verified,
+	uint8_t control, uint8_t persist, uint16_t low, uint16_t high)
+	// Same as above, also restores interrupt thresholds and interrupt control
+	// Returns true (1) if successful, false (0) if there was an I2C error or a wrong ID
+	// (Also see getError() below)
+{
+	// All registers are written before power up, so the first integration
+	// already runs with the restored thresholds and interrupt control
+	if (warmConfigure(gain,it_switch,ms,verified)
+		&& setInterruptThreshold(low,high)
+		&& setInterruptControl(control,persist))
+		return(setPowerUp());
+
+	return(false);
+}
+#endif
+
+
+boolean TSL2561::warmConfigure(boolean gain, uint8_t it_switch, uint16_t &ms, boolean verified)
+	// warmStart() without the power up
+	// Returns true (1) if successful, false (0) if there was an I2C error or a wrong ID
+	// (Also see getError() above)
+{
+	uint8_t ID;
+
+	// start the boot to first sample timer, a power up is needed before a valid sample
+	_startTime = millis();
+	_firstSample = true;
+	_poweredUp = false;
+
+	// start I2C only if needed
+	if (!_wire->isEnabled())
+		_wire->begin();
+
+	// check device ID only if it was never verified
+	if (!verified && !(readByte(TSL2561_REG_ID,ID) && ID==0x50))
+		return(false);
+
+	// Write the whole timing byte (no read-modify-write): gain, 13.7ms integration
+	if (!writeByte(TSL2561_REG_TIMING,gain ? 0x10 : 0x00))
+		return(false);
+
+	// update settings, keep the saved integration time for restoreTiming()
+	timingWritten(gain,0);
+	_warmIt = it_switch & 0x03;
+	ms = 14;
+	return(true);
+}
+
+
+boolean TSL2561::restoreTiming(uint16_t &ms)
+	// Switch to the integration time saved by warmStart(), current gain is kept
+	// ms will be set to integration time in ms
+	// Returns true (1) if successful or nothing to restore, false (0) if there was an I2C error
+	// (Also see getError() below)
+{
+	if (_warmIt != TSL2561_NO_WARM_IT)
+	{
+		// Whole timing byte is known: single write, no read-modify-write
+		if (!writeByte(TSL2561_REG_TIMING,(_gain ? 0x10 : 0x00) | _warmIt))
+		{
+			ms = integrationMs(_it);
+			return(false);
+		}
+		timingWritten(_gain,_warmIt);
+		_warmIt = TSL2561_NO_WARM_IT;
+	}
+
+	ms = integrationMs(_it);
+	return(true);
+}
+
+
 boolean TSL2561::setPowerUp(void)
 {
 	// Write 0x03 to command byte (power on)
-	return(writeByte(TSL2561_REG_CONTROL,0x03));
+	if (!writeByte(TSL2561_REG_CONTROL,0x03))
+		return(false);
+
+	// first integration ends one integration time from now
+	_powerUpTime = millis();
+	_poweredUp = true;
+	return(true);
 }
 
 
@@ -75,13 +214,7 @@ boolean TSL2561::setTiming(boolean gain, uint8_t it_switch, uint16_t &ms)
 	uint8_t timing;
 
 	// define integration time in ms for user
-	switch (it_switch)
-	{
-		case 0: ms = 14; break;
-		case 1: ms = 101; break;
-		case 2: ms = 402; break;
-		default: ms = 0;
-	}
+	ms = integrationMs(it_switch);
 
 	// Get timing byte
 	if (readByte(TSL2561_REG_TIMING,timing))
@@ -99,9 +232,9 @@ boolean TSL2561::setTiming(boolean gain, uint8_t it_switch, uint16_t &ms)
 		// Write modified timing byte back to device
 		if (writeByte(TSL2561_REG_TIMING,timing))
 		{
-			// update settings
-			_gain = gain;
-			_it = it_switch;
+			// update settings, a warm start integration time is overridden
+			timingWritten(gain,it_switch & 0x03);
+			_warmIt = TSL2561_NO_WARM_IT;
 			return(true);
 		}
 
@@ -131,7 +264,12 @@ boolean TSL2561::manualStart(void)
 
 			// Write modified timing byte back to device
 			if (writeByte(TSL2561_REG_TIMING,timing))
+			{
+				// update settings, a warm start integration time is overridden
+				timingWritten(_gain,3);
+				_warmIt = TSL2561_NO_WARM_IT;
 				return(true);
+			}
 		}
 	}
 	return(false);
@@ -165,15 +303,32 @@ boolean TSL2561::getData(uint16_t &data0, uint16_t &data1, bool autoGain)
 	// Returns true (1) if successful, false (0) if there was an I2C error
 	// (Also see getError() below)
 {
-	uint16_t it_ms;
 	// Get data0 and data1 out of result registers, if error: exit
-	if (!readUInt(TSL2561_REG_DATA_0,data0) || !readUInt(TSL2561_REG_DATA_1,data1))
+	if (!readData(data0,data1))
 		return false;
 
+	// first valid sample since begin() or warmStart(): record startup latency
+	// (reads before the end of the first integration don't count)
+	if (_firstSample && _poweredUp && (millis() - _powerUpTime >= integrationMs(_it)))
+	{
+		_startupLatency = millis() - _startTime;
+		_firstSample = false;
+	}
+
+#if !TSL2561_WITH_AUTOGAIN
+	// auto gain compiled out: raw data is valid, but the request can't be honoured
+	if (autoGain)
+	{
+		_error = TSL2561_ERROR_NO_AUTOGAIN;
+		return false;
+	}
+	return true;
+#else
 	if (!autoGain)
 		return true;// auto gain disabled, just return raw data
 	else
 	{
+		uint16_t it_ms;
 		uint16_t _hi, _lo;
 		// Get the hi/low threshold for the current integration time
 		switch(_it)
@@ -193,27 +348,21 @@ boolean TSL2561::getData(uint16_t &data0, uint16_t &data1, bool autoGain)
 		}
 
 		// check if gain needs to be adjusted
+		// (the result registers only hold data at the new gain one integration
+		// later: the data read above is returned, the next samples use the new gain)
 		if ((data0 < _lo) && !_gain)
 		// broadband value below low_thr and gain = x1
 		{
-			/* Increase the gain and try again */
+			/* Increase the gain for the next integrations */
 			setTiming(true, _it, it_ms);
-			/* update data, if error, exit right away */
-			if (readUInt(TSL2561_REG_DATA_0,data0) && readUInt(TSL2561_REG_DATA_1,data1))
-				return true;//gain adjusted, new values read: done!
-			else
-				return false;
+			return true;
 		}
 		else if ((data0 > _hi) && _gain)
 		// broadband value above high_thr and gain = x16
 		{
-			/* Drop gain to 1x and try again */
+			/* Drop gain to 1x for the next integrations */
 			setTiming(false, _it, it_ms);
-			/* update data, if error, exit right away */
-			if (readUInt(TSL2561_REG_DATA_0,data0) && readUInt(TSL2561_REG_DATA_1,data1))
-				return true;//gain adjusted, new values read: done!
-			else
-				return false;
+			return true;
 		}
 		else
 		{
@@ -221,177 +370,65 @@ boolean TSL2561::getData(uint16_t &data0, uint16_t &data1, bool autoGain)
 			return true;
 		}
 	}
+#endif
 }
 
 
-boolean TSL2561::getLux(uint16_t ms, uint16_t CH0, uint16_t CH1, double &lux)
-	// Convert raw data to lux
-	// ms: integration time in ms, from setTiming() or from manual integration
-	// CH0, CH1: results from getData()
-	// lux will be set to resulting lux calculation
-	// returns true (1) if calculation was successful
-	// RETURNS false (0) AND lux = 0.0 IF EITHER SENSOR WAS SATURATED (0XFFFF)
+boolean TSL2561::getData(TSL2561Sample &sample, bool autoGain)
+	// Retrieve raw integration results in a sample record
+	// Gain and integration time are the ones that produced the data, lux values are calculated on demand
+	// Returns true (1) if successful, false (0) if there was an I2C error
+	// (Also see getError() below)
 {
-	double ratio, d0, d1;
+	uint16_t data0, data1;
+	bool gain;
+	uint8_t it;
 
-	// Determine if either sensor saturated (0xFFFF)
-	// If so, abandon ship (calculation will not be accurate)
-	if ((CH0 == 0xFFFF) || (CH1 == 0xFFFF))
+	// settings of the integration in the result registers, before autogain changes them:
+	// the previous settings until one integration at the current ones has elapsed
+	if (timingSettled())
 	{
-		lux = 0.0;
-		return(false);
+		gain = _gain;
+		it = _it;
 	}
-
-	// Convert from unsigned integer to floating point
-	d0 = CH0; d1 = CH1;
-
-	// We will need the ratio for subsequent calculations
-	ratio = d1 / d0;
-
-	// Normalize for integration time
-	d0 *= (402.0/ms);
-	d1 *= (402.0/ms);
-
-	// Normalize for gain
-	if (!_gain)
+	else
 	{
-		d0 *= 16;
-		d1 *= 16;
+		gain = _dataGain;
+		it = _dataIt;
 	}
 
-	// Determine lux per datasheet equations:
-
-	if (ratio < 0.5)
+	if (!getData(data0,data1,autoGain))
 	{
-		lux = 0.0304 * d0 - 0.062 * d0 * pow(ratio,1.4);
-		return(true);
-	}
-
-	if (ratio < 0.61)
-	{
-		lux = 0.0224 * d0 - 0.031 * d1;
-		return(true);
+		// autogain compiled out: data was read, keep it in the record anyway
+		if (_error == TSL2561_ERROR_NO_AUTOGAIN)
+			sample.set(data0,data1,gain,it,integrationMs(it));
+		return(false);
 	}
 
-	if (ratio < 0.80)
-	{
-		lux = 0.0128 * d0 - 0.0153 * d1;
-		return(true);
-	}
+	sample.set(data0,data1,gain,it,integrationMs(it));
+	return(true);
+}
 
-	if (ratio < 1.30)
-	{
-		lux = 0.00146 * d0 - 0.00112 * d1;
-		return(true);
-	}
 
-	// if (ratio > 1.30)
-	lux = 0.0;
-	return(true);
+#if TSL2561_WITH_FLOAT_LUX
+boolean TSL2561::getLux(uint16_t ms, uint16_t CH0, uint16_t CH1, double &lux)
+	// Convert raw data to lux with the current gain setting
+	// (see tsl2561_lux() in tsl2561_lux.cpp)
+{
+	return(tsl2561_lux(_gain,ms,CH0,CH1,lux));
 }
+#endif
 
-// alternate int based illuminance calculation
+#if TSL2561_WITH_INT_LUX
 boolean TSL2561::getLuxInt(uint16_t CH0, uint16_t CH1, uint32_t &lux)
-// Convert raw data to lux as integer
-// this is not available for custom integration time
-// this function uses integer based approximate calculation but accuracy compared...
-// ...to getLux:float is very good (max 2%, probably smaller than sensor accuracy)
-// CH0, CH1: results from getData()
-// lux will be set to illuminance value in lux
-// returns true (1) if calculation was successful
-// RETURNS false (0) AND lux = 0 IF EITHER SENSOR WAS SATURATED (0XFFFF)
+	// Convert raw data to lux as integer with the current gain and integration time
+	// (see tsl2561_luxInt() in tsl2561_lux.cpp)
 {
-  unsigned long chScale;
-  unsigned long channel1;
-  unsigned long channel0;
-
-  /* Make sure the sensor isn't saturated! */
-  uint16_t clipThreshold;
-  switch (_it)
-  {
-    case 0:
-      clipThreshold = TSL2561_CLIPPING_13MS;
-      break;
-    case 1:
-      clipThreshold = TSL2561_CLIPPING_101MS;
-      break;
-    default:
-      clipThreshold = TSL2561_CLIPPING_402MS;
-      break;
-  }
-
-  /* Return false and lux=0 if the sensor is saturated */
-  if ((CH0 > clipThreshold) || (CH1> clipThreshold))
-  {
-		lux = 0;
-    return false;
-  }
-
-  /* Get the correct scale depending on the intergration time */
-
-  switch (_it)
-  {
-    case 0:
-      chScale = TSL2561_LUX_CHSCALE_TINT0;
-      break;
-    case 1:
-      chScale = TSL2561_LUX_CHSCALE_TINT1;
-      break;
-    default: // No scaling ... integration time = 402ms
-      chScale = (1 << TSL2561_LUX_CHSCALE);
-      break;
-  }
-
-  // Scale for gain (1x or 16x)
-  if (!_gain) chScale = chScale << 4;
-
-  // scale the channel values
-  channel0 = (CH0 * chScale) >> TSL2561_LUX_CHSCALE;
-  channel1 = (CH1 * chScale) >> TSL2561_LUX_CHSCALE;
-
-  // find the ratio of the channel values (Channel1/Channel0)
-  unsigned long ratio1 = 0;
-  if (channel0 != 0) ratio1 = (channel1 << (TSL2561_LUX_RATIOSCALE+1)) / channel0;
-
-  // round the ratio value
-  unsigned long ratio = (ratio1 + 1) >> 1;
-
-  unsigned int b, m;
-
-
-  if ((ratio >= 0) && (ratio <= TSL2561_LUX_K1T))
-  {b=TSL2561_LUX_B1T; m=TSL2561_LUX_M1T;}
-  else if (ratio <= TSL2561_LUX_K2T)
-  {b=TSL2561_LUX_B2T; m=TSL2561_LUX_M2T;}
-  else if (ratio <= TSL2561_LUX_K3T)
-  {b=TSL2561_LUX_B3T; m=TSL2561_LUX_M3T;}
-  else if (ratio <= TSL2561_LUX_K4T)
-  {b=TSL2561_LUX_B4T; m=TSL2561_LUX_M4T;}
-  else if (ratio <= TSL2561_LUX_K5T)
-  {b=TSL2561_LUX_B5T; m=TSL2561_LUX_M5T;}
-  else if (ratio <= TSL2561_LUX_K6T)
-  {b=TSL2561_LUX_B6T; m=TSL2561_LUX_M6T;}
-  else if (ratio <= TSL2561_LUX_K7T)
-  {b=TSL2561_LUX_B7T; m=TSL2561_LUX_M7T;}
-  else if (ratio > TSL2561_LUX_K8T)
-  {b=TSL2561_LUX_B8T; m=TSL2561_LUX_M8T;}
-
-  unsigned long temp;
-  temp = ((channel0 * b) - (channel1 * m));
-
-  // do not allow negative lux value
-  if (temp < 0) temp = 0;
-
-  // round lsb (2^(LUX_SCALE-1))
-  temp += (1 << (TSL2561_LUX_LUXSCALE-1));
-
-  // strip off fractional portion
-  lux = temp >> TSL2561_LUX_LUXSCALE;
-
-  // Signal I2C had no errors
-  return true;
+	return(tsl2561_luxInt(_gain,_it,CH0,CH1,lux));
 }
+#endif
 
+#if TSL2561_WITH_INTERRUPTS
 boolean TSL2561::setInterruptControl(uint8_t control, uint8_t persist)
 	// Sets up interrupt operations
 	// If control = 0, interrupt output disabled
@@ -403,7 +440,7 @@ boolean TSL2561::setInterruptControl(uint8_t control, uint8_t persist)
 	// (Also see getError() below)
 {
 	// Place control and persist bits into proper location in interrupt control register
-	if (writeByte(TSL2561_REG_INTCTL,((control | 0B00000011) << 4) & (persist | 0B00001111)))
+	if (writeByte(TSL2561_REG_INTCTL,((control & 0B00000011) << 4) | (persist & 0B00001111)))
 		return(true);
 
 	return(false);
@@ -430,14 +467,15 @@ boolean TSL2561::clearInterrupt(void)
 	// (Also see getError() below)
 {
 	// Set up command byte for interrupt clear
-	Wire.beginTransmission(_i2c_address);
-	Wire.write(TSL2561_CMD_CLEAR);
-	_error = Wire.endTransmission();
+	_wire->beginTransmission(_i2c_address);
+	_wire->write(TSL2561_CMD_CLEAR);
+	_error = _wire->endTransmission();
 	if (_error == 0)
 		return(true);
 
 	return(false);
 }
+#endif
 
 
 boolean TSL2561::getID(uint8_t &ID)
@@ -454,6 +492,19 @@ boolean TSL2561::getID(uint8_t &ID)
 }
 
 
+uint32_t TSL2561::getStartupLatency(void)
+	// Time in ms from begin() or warmStart() to the first successful getData()
+	// made at least one integration time after power up
+	// Includes the caller's own delay before that getData()
+	// Returns 0 until such a sample was read
+{
+	if (_firstSample)
+		return(0);
+
+	return(_startupLatency);
+}
+
+
 uint8_t TSL2561::getError(void)
 	// If any library command fails, you can retrieve an extended
 	// error code using this command. Errors are from the wire library:
@@ -462,6 +513,7 @@ uint8_t TSL2561::getError(void)
 	// 2 = Received NACK on transmit of address
 	// 3 = Received NACK on transmit of data
 	// 4 = Other error
+	// 5 = autoGain requested but compiled out (TSL2561_WITH_AUTOGAIN = 0)
 {
 	return(_error);
 }
@@ -475,18 +527,18 @@ boolean TSL2561::readByte(uint8_t address, uint8_t &value)
 	// Returns true (1) if successful, false (0) if there was an I2C error
 	// (Also see getError() above)
 {
-	// Set up command byte for read
-	Wire.beginTransmission(_i2c_address);
-	Wire.write((address & 0x0F) | TSL2561_CMD);
-	_error = Wire.endTransmission();
+	// Set up command byte for read, keep the bus (repeated start)
+	_wire->beginTransmission(_i2c_address);
+	_wire->write((address & 0x0F) | TSL2561_CMD);
+	_error = _wire->endTransmission(false);
 
 	// Read requested byte
 	if (_error == 0)
 	{
-		Wire.requestFrom(_i2c_address,1);
-		if (Wire.available() == 1)
+		_wire->requestFrom(_i2c_address,1);
+		if (_wire->available() == 1)
 		{
-			value = Wire.read();
+			value = _wire->read();
 			return(true);
 		}
 	}
@@ -502,11 +554,11 @@ boolean TSL2561::writeByte(uint8_t address, uint8_t value)
 	// (Also see getError() above)
 {
 	// Set up command byte for write
-	Wire.beginTransmission(_i2c_address);
-	Wire.write((address & 0x0F) | TSL2561_CMD);
+	_wire->beginTransmission(_i2c_address);
+	_wire->write((address & 0x0F) | TSL2561_CMD);
 	// Write byte
-	Wire.write(value);
-	_error = Wire.endTransmission();
+	_wire->write(value);
+	_error = _wire->endTransmission();
 	if (_error == 0)
 		return(true);
 
@@ -523,19 +575,19 @@ boolean TSL2561::readUInt(uint8_t address, uint16_t &value)
 {
 	uint8_t high, low;
 
-	// Set up command byte for read
-	Wire.beginTransmission(_i2c_address);
-	Wire.write((address & 0x0F) | TSL2561_CMD);
-	_error = Wire.endTransmission();
+	// Set up command byte for read, keep the bus (repeated start)
+	_wire->beginTransmission(_i2c_address);
+	_wire->write((address & 0x0F) | TSL2561_CMD);
+	_error = _wire->endTransmission(false);
 
 	// Read two bytes (low and high)
 	if (_error == 0)
 	{
-		Wire.requestFrom(_i2c_address,2);
-		if (Wire.available() == 2)
+		_wire->requestFrom(_i2c_address,2);
+		if (_wire->available() == 2)
 		{
-			low = Wire.read();
-			high = Wire.read();
+			low = _wire->read();
+			high = _wire->read();
 			// Combine bytes into unsigned int
 			value = (high << 8) | low;
 			return(true);
@@ -552,10 +604,71 @@ boolean TSL2561::writeUInt(uint8_t address, uint16_t value)
 	// Returns true (1) if successful, false (0) if there was an I2C error
 	// (Also see getError() above)
 {
-	// Split int into lower and upper bytes, write each byte
-	if (writeByte(address,(value & 0xFF))
-		&& writeByte(address + 1,(value >> 8)))
+	// Set up command byte for word write
+	_wire->beginTransmission(_i2c_address);
+	_wire->write((address & 0x0F) | TSL2561_CMD | TSL2561_CMD_WORD);
+	// Write lower and upper bytes in the same transaction
+	_wire->write(value & 0xFF);
+	_wire->write(value >> 8);
+	_error = _wire->endTransmission();
+	if (_error == 0)
 		return(true);
 
 	return(false);
 }
+
+
+boolean TSL2561::readData(uint16_t &data0, uint16_t &data1)
+	// Reads both channels (data0 low/high, data1 low/high) in a single transaction
+	// data0, data1 will be set to stored unsigned integers
+	// Returns true (1) if successful, false (0) if there was an I2C error
+	// (Also see getError() above)
+{
+	uint8_t buf[4];
+
+	// Set up command byte for read from channel 0, keep the bus (repeated start)
+	_wire->beginTransmission(_i2c_address);
+	_wire->write(TSL2561_REG_DATA_0 | TSL2561_CMD);
+	_error = _wire->endTransmission(false);
+
+	// Read four bytes, register address auto-increments
+	if (_error == 0)
+	{
+		_wire->requestFrom(_i2c_address,4);
+		if (_wire->available() == 4)
+		{
+			for (uint8_t i = 0; i < 4; i++)
+				buf[i] = _wire->read();
+			// Combine bytes into unsigned ints
+			data0 = (buf[1] << 8) | buf[0];
+			data1 = (buf[3] << 8) | buf[2];
+			return(true);
+		}
+	}
+	return(false);
+}
+
+
+void TSL2561::timingWritten(boolean gain, uint8_t it_switch)
+	// Update settings after a write to the timing register
+	// The result registers keep data of the previous settings until one integration
+	// at the new settings has elapsed
+{
+	// the settings being replaced produced the data only if they were in place long enough
+	if (timingSettled())
+	{
+		_dataGain = _gain;
+		_dataIt = _it;
+	}
+
+	_gain = gain;
+	_it = it_switch;
+	_timingTime = millis();
+}
+
+
+boolean TSL2561::timingSettled(void)
+	// Returns true (1) if one integration has elapsed since the last timing write
+{
+	return(millis() - _timingTime >= integrationMs(_it));
+}
@@ -21,15 +21,29 @@
 #ifndef TSL2561_h
 #define TSL2561_h
 
+#include "tsl2561_config.h"
+#include "tsl2561_lux.h"
+#include "tsl2561_sample.h"
+
 class TSL2561
 {
 
 	public:
 
 	char _i2c_address;
+	TwoWire *_wire;
 	uint8_t _error;
 	bool _gain;
 	uint8_t _it;
+	uint32_t _startTime;
+	uint32_t _powerUpTime;
+	bool _poweredUp;
+	uint32_t _startupLatency;
+	bool _firstSample;
+	uint8_t _warmIt;
+	bool _dataGain;
+	uint8_t _dataIt;
+	uint32_t _timingTime;
 
 	public:
 		TSL2561(uint8_t i2c_address);
@@ -38,10 +52,41 @@ class TSL2561
 		// TSL2561_ADDR   (0x39 default address, pin floating)
 		// TSL2561_ADDR_1 (0x49 address with '1' connected to VIN)
 
+		TSL2561(uint8_t i2c_address, TwoWire &wire);
+		// TSL2561 object on another I2C bus (Wire1 on Electron for instance)
+		// i2c_address: same as above
+		// wire: I2C bus the sensor is connected to
+
 		boolean begin(void);
 		// Initialize TSL2561 library
 		// returns true if device connected
 
+		boolean warmStart(boolean gain, uint8_t time, uint16_t &ms, boolean verified);
+		// Fast bring-up of a device with saved gain and integration time (after boot or wake)
+		// Writes the timing byte and powers up: 2 writes, no read-modify-write
+		// If verified = true, the device ID check is skipped (I2C is only started if needed)
+		// First integration is 13.7ms so a valid sample is available as soon as possible
+		// ms will be set to 14, call restoreTiming() after the first sample to switch to time
+		// Returns true (1) if successful, false (0) if there was an I2C error or a wrong ID
+		// (Also see getError() below)
+
+#if TSL2561_WITH_INTERRUPTS
+		boolean warmStart(boolean gain, uint8_t time, uint16_t &ms, boolean verified,
+			uint8_t control, uint8_t persist, uint16_t low, uint16_t high);
+		// Same as above, also restores interrupt thresholds (low, high) and interrupt
+		// control (control, persist), see setInterruptControl() and setInterruptThreshold()
+		// All registers are written before the power up, the first integration already uses them
+		// Returns true (1) if successful, false (0) if there was an I2C error or a wrong ID
+		// (Also see getError() below)
+#endif
+
+		boolean restoreTiming(uint16_t &ms);
+		// Switch to the integration time saved by warmStart() (current gain is kept)
+		// Single write of the whole timing byte, does nothing if there is nothing to restore
+		// ms will be set to integration time in ms
+		// Returns true (1) if successful, false (0) if there was an I2C error
+		// (Also see getError() below)
+
 		boolean setPowerUp(void);
 		// Turn on TSL2561, begin integration
 		// Returns true (1) if successful, false (0) if there was an I2C error
@@ -77,7 +122,7 @@ class TSL2561
 		boolean manualStart(void);
 		// Starts a manual integration period
 		// After running this command, you must manually stop integration with manualStop()
-		// Internally sets integration time to 3 for manual integration (gain is unchanged)
+		// Internally sets integration time to 3 for manual integration (gain is unchanged, _it = 3)
 		// Returns true (1) if successful, false (0) if there was an I2C error
 		// (Also see getError() below)
 
@@ -90,27 +135,52 @@ class TSL2561
 		// Retrieve raw integration results
 		// CH0 and CH1 will be set to integration results
 		// if autoGain is true, autogain is enabled and the gain will be adjusted if needed
+		// (for the next integrations: CH0/CH1 are still from the previous gain)
+		// When TSL2561_WITH_AUTOGAIN is 0, autoGain = true fails (CH0/CH1 are still set)
+		// with error TSL2561_ERROR_NO_AUTOGAIN
 		// Returns true (1) if successful, false (0) if there was an I2C error
 		// (Also see getError() below)
 
+		boolean getData(TSL2561Sample &sample, bool autoGain);
+		// Identical to above command, except results are stored in a sample record
+		// together with the gain and integration time that produced them
+		// (after setTiming(), restoreTiming() or an autogain switch, the previous settings
+		// until one integration at the new settings has elapsed)
+		// When TSL2561_WITH_AUTOGAIN is 0, autoGain = true fails with error
+		// TSL2561_ERROR_NO_AUTOGAIN, the record is still set
+		// Lux values are only calculated when asked for with sample.getLux() / sample.getLuxInt()
+		// After a manual integration, ms is unknown (0) and both conversions fail:
+		// use sample.set() with the measured integration time instead
+		// Returns true (1) if successful, false (0) if there was an I2C error
+		// (Also see getError() below)
+
+#if TSL2561_WITH_FLOAT_LUX
 		boolean getLux(uint16_t ms, uint16_t CH0, uint16_t CH1, double &lux);
 		// Convert raw data to lux
 		// ms: integration time in ms, from setTiming() or from manual integration
+		// (ms = 14 is taken as the nominal 13.7ms integration)
 		// CH0, CH1: results from getData()
 		// lux will be set to resulting lux calculation
 		// returns true (1) if calculation was successful
 		// RETURNS false (0) AND lux = 0.0 IF EITHER SENSOR WAS SATURATED (0XFFFF)
+#endif
 
+#if TSL2561_WITH_INT_LUX
 		boolean getLuxInt(uint16_t CH0, uint16_t CH1, uint32_t &lux);
 		// Convert raw data to lux as integer
 		// this is not available for custom integration time
-		// this function uses integer based approximate calculation but accuracy compared...
-		// ...to getLux:float is very good (max 2%, probably smaller than sensor accuracy)
+		// this function uses integer based approximate calculation, it does not use the same
+		// ratio breakpoints nor the same saturation rule as getLux:float (clipping thresholds)
+		// share of readings within 1% of getLux / off by more than 10% (gain x1, x16, lux >= 1):
+		// 13.7ms: 56% / 14%, 101ms: 51% / 14%, 402ms: 55% / 13-14%
+		// the largest errors are at low lux and near ratio 1.3, see extras/lux_sweep
 		// CH0, CH1: results from getData()
 		// lux will be set to illuminance value in lux
 		// returns true (1) if calculation was successful
-		// RETURNS false (0) AND lux = 0 IF EITHER SENSOR WAS SATURATED (0XFFFF)
+		// RETURNS false (0) AND lux = 0 IF EITHER SENSOR WAS ABOVE THE CLIPPING THRESHOLD
+#endif
 
+#if TSL2561_WITH_INTERRUPTS
 		boolean setInterruptControl(uint8_t control, uint8_t persist);
 		// Sets up interrupt operations
 		// If control = 0, interrupt output disabled
@@ -131,6 +201,7 @@ class TSL2561
 		// Clears an active interrupt
 		// Returns true (1) if successful, false (0) if there was an I2C error
 		// (Also see getError() below)
+#endif
 
 		boolean getID(uint8_t &ID);
 		// Retrieves part and revision code from TSL2561
@@ -138,6 +209,12 @@ class TSL2561
 		// Returns true (1) if successful, false (0) if there was an I2C error
 		// (Also see getError() below)
 
+		uint32_t getStartupLatency(void);
+		// Time in ms from begin() or warmStart() to the first successful getData()
+		// made at least one integration time after a setPowerUp() (or warmStart()) since then
+		// Includes the caller's own delay before that getData()
+		// Returns 0 until such a sample was read
+
 		uint8_t getError(void);
 		// If any library command fails, you can retrieve an extended
 		// error code using this command. Errors are from the wire library:
@@ -146,6 +223,7 @@ class TSL2561
 		// 2 = Received NACK on transmit of address
 		// 3 = Received NACK on transmit of data
 		// 4 = Other error
+		// 5 = autoGain requested but compiled out (TSL2561_ERROR_NO_AUTOGAIN)
 
 		private:
 
@@ -172,20 +250,48 @@ class TSL2561
 
 		boolean writeUInt(uint8_t address, uint16_t value);
 		// Write an unsigned integer (16 bits) to a TSL2561 address (low byte first)
+		// Uses a single word write transaction
 		// Address: TSL2561 address (0 to 15), low byte first
 		// Value: unsigned int to write to address
 		// Returns true (1) if successful, false (0) if there was an I2C error
 		// (Also see getError() above)
+
+		boolean warmConfigure(boolean gain, uint8_t time, uint16_t &ms, boolean verified);
+		// warmStart() without the power up: timer, I2C start, ID check, timing byte
+		// Returns true (1) if successful, false (0) if there was an I2C error or a wrong ID
+		// (Also see getError() above)
+
+		void timingWritten(boolean gain, uint8_t time);
+		// Update settings after a write to the timing register
+		// The result registers keep data of the previous settings (_dataGain, _dataIt)
+		// until one integration at the new settings has elapsed
+
+		boolean timingSettled(void);
+		// Returns true (1) if one integration has elapsed since the last timing write:
+		// the result registers hold data of the current settings
+
+		boolean readData(uint16_t &data0, uint16_t &data1);
+		// Reads both channel registers in one I2C transaction (repeated start)
+		// data0, data1 will be set to channel 0 and channel 1 values
+		// Returns true (1) if successful, false (0) if there was an I2C error
+		// (Also see getError() above)
 };
 
 #define TSL2561_ADDR_0 0x29 // address with '0' shorted on board
 #define TSL2561_ADDR   0x39 // default address
 #define TSL2561_ADDR_1 0x49 // address with '1' shorted on board
 
+// Library error code (getError()), after the wire library codes
+#define TSL2561_ERROR_NO_AUTOGAIN 5
+
+// _warmIt value when there is no integration time to restore
+#define TSL2561_NO_WARM_IT        0xFF
+
 // TSL2561 registers
 
 #define TSL2561_CMD           0x80
 #define TSL2561_CMD_CLEAR     0xC0
+#define TSL2561_CMD_WORD      0x20
 #define	TSL2561_REG_CONTROL   0x00
 #define	TSL2561_REG_TIMING    0x01
 #define	TSL2561_REG_THRESH_L  0x02
@@ -195,33 +301,6 @@ class TSL2561
 #define	TSL2561_REG_DATA_0    0x0C
 #define	TSL2561_REG_DATA_1    0x0E
 
-// Int based illuminance calculation
-// T, FN and CL package values
-#define TSL2561_LUX_K1T           (0x0040)  // 0.125 * 2^RATIO_SCALE
-#define TSL2561_LUX_B1T           (0x01f2)  // 0.0304 * 2^LUX_SCALE
-#define TSL2561_LUX_M1T           (0x01be)  // 0.0272 * 2^LUX_SCALE
-#define TSL2561_LUX_K2T           (0x0080)  // 0.250 * 2^RATIO_SCALE
-#define TSL2561_LUX_B2T           (0x0214)  // 0.0325 * 2^LUX_SCALE
-#define TSL2561_LUX_M2T           (0x02d1)  // 0.0440 * 2^LUX_SCALE
-#define TSL2561_LUX_K3T           (0x00c0)  // 0.375 * 2^RATIO_SCALE
-#define TSL2561_LUX_B3T           (0x023f)  // 0.0351 * 2^LUX_SCALE
-#define TSL2561_LUX_M3T           (0x037b)  // 0.0544 * 2^LUX_SCALE
-#define TSL2561_LUX_K4T           (0x0100)  // 0.50 * 2^RATIO_SCALE
-#define TSL2561_LUX_B4T           (0x0270)  // 0.0381 * 2^LUX_SCALE
-#define TSL2561_LUX_M4T           (0x03fe)  // 0.0624 * 2^LUX_SCALE
-#define TSL2561_LUX_K5T           (0x0138)  // 0.61 * 2^RATIO_SCALE
-#define TSL2561_LUX_B5T           (0x016f)  // 0.0224 * 2^LUX_SCALE
-#define TSL2561_LUX_M5T           (0x01fc)  // 0.0310 * 2^LUX_SCALE
-#define TSL2561_LUX_K6T           (0x019a)  // 0.80 * 2^RATIO_SCALE
-#define TSL2561_LUX_B6T           (0x00d2)  // 0.0128 * 2^LUX_SCALE
-#define TSL2561_LUX_M6T           (0x00fb)  // 0.0153 * 2^LUX_SCALE
-#define TSL2561_LUX_K7T           (0x029a)  // 1.3 * 2^RATIO_SCALE
-#define TSL2561_LUX_B7T           (0x0018)  // 0.00146 * 2^LUX_SCALE
-#define TSL2561_LUX_M7T           (0x0012)  // 0.00112 * 2^LUX_SCALE
-#define TSL2561_LUX_K8T           (0x029a)  // 1.3 * 2^RATIO_SCALE
-#define TSL2561_LUX_B8T           (0x0000)  // 0.000 * 2^LUX_SCALE
-#define TSL2561_LUX_M8T           (0x0000)  // 0.000 * 2^LUX_SCALE
-
 // Auto-gain thresholds
 #define TSL2561_AGC_THI_13MS      (4850)    // Max value at Ti 13ms = 5047
 #define TSL2561_AGC_TLO_13MS      (100)
@@ -229,16 +308,5 @@ class TSL2561
 #define TSL2561_AGC_TLO_101MS     (200)
 #define TSL2561_AGC_THI_402MS     (63000)   // Max value at Ti 402ms = 65535
 #define TSL2561_AGC_TLO_402MS     (500)
-// Clipping thresholds
-#define TSL2561_CLIPPING_13MS     (4900)
-#define TSL2561_CLIPPING_101MS    (37000)
-#define TSL2561_CLIPPING_402MS    (65000)
-// scale cofficients
-#define TSL2561_LUX_LUXSCALE      (14)      // Scale by 2^14
-#define TSL2561_LUX_RATIOSCALE    (9)       // Scale ratio by 2^9
-#define TSL2561_LUX_CHSCALE       (10)      // Scale channel values by 2^10
-#define TSL2561_LUX_CHSCALE_TINT0 (0x7517)  // 322/11 * 2^TSL2561_LUX_CHSCALE
-#define TSL2561_LUX_CHSCALE_TINT1 (0x0FE7)  // 322/81 * 2^TSL2561_LUX_CHSCALE
-
 
 #endif
@@ -0,0 +1,40 @@
+/*
+	Build profiles for the TSL2561 library (see README, Build profiles).
+*/
+
+#ifndef TSL2561_config_h
+#define TSL2561_config_h
+
+// Build profiles
+// Select one with -DTSL2561_PROFILE=<value> for the whole build (e.g. EXTRA_CFLAGS in a local build)
+// A #define in the application .ino does not reach tsl2561.cpp: library and app would disagree
+// TSL2561_PROFILE_INT:   getLuxInt() and autogain, no double math / libm, no interrupts
+// TSL2561_PROFILE_FLOAT: getLux() and autogain, no interrupts
+// TSL2561_PROFILE_FULL:  everything (default)
+// Each feature can also be forced on (1) or off (0) with its TSL2561_WITH_* flag
+// Without autogain, getData() fails (error TSL2561_ERROR_NO_AUTOGAIN) when autoGain is requested
+#define TSL2561_PROFILE_INT       1
+#define TSL2561_PROFILE_FLOAT     2
+#define TSL2561_PROFILE_FULL      3
+
+#ifndef TSL2561_PROFILE
+#define TSL2561_PROFILE           TSL2561_PROFILE_FULL
+#endif
+
+#ifndef TSL2561_WITH_FLOAT_LUX
+#define TSL2561_WITH_FLOAT_LUX    (TSL2561_PROFILE != TSL2561_PROFILE_INT)
+#endif
+
+#ifndef TSL2561_WITH_INT_LUX
+#define TSL2561_WITH_INT_LUX      (TSL2561_PROFILE != TSL2561_PROFILE_FLOAT)
+#endif
+
+#ifndef TSL2561_WITH_AUTOGAIN
+#define TSL2561_WITH_AUTOGAIN     1
+#endif
+
+#ifndef TSL2561_WITH_INTERRUPTS
+#define TSL2561_WITH_INTERRUPTS   (TSL2561_PROFILE == TSL2561_PROFILE_FULL)
+#endif
+
+#endif
@@ -0,0 +1,134 @@
+/*
+	Illuminance estimator for the TAOS TSL2561 Illumination Sensor.
+	Fixed point alpha-beta filter: the level follows the samples with gain
+	1/2^alphaShift, the trend (lux per second) with gain 1/2^betaShift.
+*/
+
+#include "tsl2561_estimator.h"
+
+// saturate a 64 bit intermediate result to the 32 bit state
+static int32_t clamp32(int64_t value)
+{
+	if (value > INT32_MAX) return INT32_MAX;
+	if (value < INT32_MIN) return INT32_MIN;
+	return (int32_t)value;
+}
+
+
+TSL2561Estimator::TSL2561Estimator(uint8_t alphaShift, uint8_t betaShift){
+	_alphaShift = alphaShift;
+	_betaShift = betaShift;
+	reset();
+}
+
+
+void TSL2561Estimator::reset(void)
+	// Forget all samples
+{
+	_level = 0;
+	_trend = 0;
+	_deviation = 0;
+	_time = 0;
+	_interval = 0;
+	_samples = 0;
+}
+
+
+void TSL2561Estimator::update(uint32_t lux, uint32_t time)
+	// Add a new sample
+	// lux: illuminance value in lux, from getLuxInt() for instance
+	// time: time in ms at the end of the integration (millis())
+{
+	int32_t sample, predicted, residual;
+	uint32_t dt;
+
+	// keep the scaled value inside the state range
+	if (lux > (INT32_MAX >> TSL2561_EST_SCALE))
+		lux = INT32_MAX >> TSL2561_EST_SCALE;
+	sample = (int32_t)(lux << TSL2561_EST_SCALE);
+
+	// first sample: start from it, no trend yet
+	if (_samples == 0)
+	{
+		_level = sample;
+		_trend = 0;
+		_deviation = 0;
+		_time = time;
+		_interval = 0;
+		_samples = 1;
+		return;
+	}
+
+	dt = time - _time;
+	if (dt == 0) dt = 1;
+
+	// predict the level at sample time with the current trend
+	predicted = clamp32(_level + ((int64_t)_trend * dt) / 1000);
+	residual = clamp32((int64_t)sample - predicted);
+
+	// correct level and trend with the prediction error
+	_level = clamp32(predicted + residual / (1L << _alphaShift));
+	_trend = clamp32(_trend + ((int64_t)(residual / (1L << _betaShift)) * 1000) / dt);
+
+	// track the mean absolute prediction error
+	int64_t error = residual < 0 ? -(int64_t)residual : residual;
+	_deviation = (uint32_t)((int64_t)_deviation + (error - (int64_t)_deviation) / (1 << TSL2561_EST_DEVSHIFT));
+
+	_time = time;
+	_interval = dt;
+	if (_samples < 255) _samples++;
+}
+
+
+bool TSL2561Estimator::estimate(uint32_t time, uint32_t &lux, uint32_t &uncertainty)
+	// Estimate illuminance at a given time, constant time, no I2C traffic
+	// lux will be set to estimated illuminance in lux
+	// uncertainty will be set to the expected error in lux: mean prediction error
+	// plus the trend extrapolation, growing after one interval without a sample
+	// see tsl2561_estimator.h
+	// returns true (1) if estimation was successful
+	// RETURNS false (0) AND lux = 0 IF NO SAMPLE WAS ADDED YET
+	// RETURNS false (0) IF THE ESTIMATE IS STALE (lux and uncertainty are still set)
+{
+	uint32_t age, horizon, interval, span;
+	int64_t value, spread;
+
+	if (_samples == 0)
+	{
+		lux = 0;
+		uncertainty = 0;
+		return(false);
+	}
+
+	// time before the last sample: use the last sample
+	age = time - _time;
+	if ((int32_t)age < 0) age = 0;
+
+	// follow the trend for at most one sample interval
+	horizon = (age < _interval) ? age : _interval;
+	value = _level + ((int64_t)_trend * horizon) / 1000;
+	if (value < 0) value = 0;
+
+	// time the uncertainty grows over: the estimate is stale after TSL2561_EST_STALE intervals
+	interval = (_interval != 0) ? _interval : TSL2561_EST_INTERVAL;
+	span = ((uint64_t)age < (uint64_t)interval * TSL2561_EST_STALE) ? age : interval * TSL2561_EST_STALE;
+
+	// the trend may be wrong: add the part of the estimate that comes from it
+	// (same horizon as the estimate)
+	spread = (_trend < 0) ? -(int64_t)_trend : _trend;
+	spread = (spread * horizon) / 1000;
+	// no sample for more than one interval: the prediction error grows with the time missed
+	if (span > interval)
+		spread += ((int64_t)_deviation * span) / interval;
+	else
+		spread += _deviation;
+
+	// round and strip off fractional portion
+	lux = (uint32_t)((value + (1 << (TSL2561_EST_SCALE-1))) >> TSL2561_EST_SCALE);
+	spread = (spread + (1 << (TSL2561_EST_SCALE-1))) >> TSL2561_EST_SCALE;
+	uncertainty = (spread > UINT32_MAX) ? UINT32_MAX : (uint32_t)spread;
+
+	if (age > span)
+		return(false);
+	return(true);
+}
@@ -0,0 +1,70 @@
+/*
+	Illuminance estimator for the TAOS TSL2561 Illumination Sensor.
+	Tracks level and trend of the lux samples (fixed point alpha-beta filter,
+	a steady state Kalman filter) so "lux now" can be asked at any rate, in constant
+	time and without I2C traffic, between two integrations.
+	This part of the library does not depend on the Particle API: times are given
+	by the caller (millis() on the device).
+*/
+
+#include <stdint.h>
+
+#ifndef TSL2561_estimator_h
+#define TSL2561_estimator_h
+
+class TSL2561Estimator
+{
+
+	public:
+
+	int32_t _level;       // filtered lux, scaled by 2^TSL2561_EST_SCALE
+	int32_t _trend;       // lux per second, scaled by 2^TSL2561_EST_SCALE
+	uint32_t _deviation;  // mean absolute prediction error, scaled by 2^TSL2561_EST_SCALE
+	uint32_t _time;       // time of the last sample in ms
+	uint32_t _interval;   // time between the last two samples in ms
+	uint8_t _samples;     // number of samples so far (saturates at 255)
+	uint8_t _alphaShift;
+	uint8_t _betaShift;
+
+	public:
+		TSL2561Estimator(uint8_t alphaShift = 1, uint8_t betaShift = 3);
+		// Estimator object
+		// alphaShift: level gain = 1/2^alphaShift (0: follow samples, larger: smoother)
+		// betaShift: trend gain = 1/2^betaShift (larger: slower trend changes)
+
+		void reset(void);
+		// Forget all samples
+
+		void update(uint32_t lux, uint32_t time);
+		// Add a new sample
+		// lux: illuminance value in lux, from getLuxInt() for instance
+		// time: time in ms at the end of the integration (millis())
+
+		bool estimate(uint32_t time, uint32_t &lux, uint32_t &uncertainty);
+		// Estimate illuminance at a given time, constant time, no I2C traffic
+		// time: time in ms (millis()), normally after the last sample
+		// The trend is followed for at most one sample interval after the last sample
+		// lux will be set to estimated illuminance in lux
+		// uncertainty will be set to the expected error in lux of the returned estimate:
+		// mean absolute error of past predictions, plus the trend extrapolation part of
+		// the estimate (|trend| x time followed, at most one sample interval)
+		// After one sample interval without a new sample the prediction error part grows
+		// with the time since the last sample (x2 after two intervals...), up to
+		// TSL2561_EST_STALE sample intervals
+		// returns true (1) if estimation was successful
+		// RETURNS false (0) AND lux = 0 IF NO SAMPLE WAS ADDED YET
+		// RETURNS false (0) IF NO SAMPLE WAS ADDED FOR MORE THAN TSL2561_EST_STALE SAMPLE
+		// INTERVALS (stale estimate, lux and uncertainty are still set)
+};
+
+// Fixed point scale of level, trend and deviation
+#define TSL2561_EST_SCALE         (8)       // Scale by 2^8
+// deviation gain = 1/2^TSL2561_EST_DEVSHIFT
+#define TSL2561_EST_DEVSHIFT      (2)
+// estimate is stale after this many sample intervals without a new sample
+#define TSL2561_EST_STALE         (4)
+// sample interval in ms assumed until a second sample is added (longest integration)
+#define TSL2561_EST_INTERVAL      (402)
+
+
+#endif
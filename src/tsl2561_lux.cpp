@@ -0,0 +1,201 @@
+/*
+	Lux conversion for the TAOS TSL2561 Illumination Sensor.
+	This part of the library does not depend on the Particle API so it can also
+	be built on a host computer (see extras/lux_sweep).
+
+	Float based calculation from SparkFun Electronics, integer based calculation
+	from Adafruit (see tsl2561.cpp).
+*/
+
+#include "tsl2561_lux.h"
+#if TSL2561_WITH_FLOAT_LUX
+#include "math.h" //needed to use pow(x,a)
+#endif
+
+
+#if TSL2561_WITH_FLOAT_LUX
+bool tsl2561_lux(bool gain, uint16_t ms, uint16_t CH0, uint16_t CH1, double &lux)
+	// Convert raw data to lux
+	// gain: gain used for the integration (false: x1, true: x16)
+	// ms: integration time in ms, from setTiming() or from manual integration
+	// (ms = 14 is taken as the nominal 13.7ms integration)
+	// CH0, CH1: results from getData()
+	// lux will be set to resulting lux calculation
+	// returns true (1) if calculation was successful
+	// RETURNS false (0) AND lux = 0.0 IF EITHER SENSOR WAS SATURATED (0XFFFF)
+{
+	double ratio, d0, d1, scale;
+
+	// Determine if either sensor saturated (0xFFFF)
+	// If so, abandon ship (calculation will not be accurate)
+	if ((CH0 == 0xFFFF) || (CH1 == 0xFFFF))
+	{
+		lux = 0.0;
+		return(false);
+	}
+
+	// Convert from unsigned integer to floating point
+	d0 = CH0; d1 = CH1;
+
+	// We will need the ratio for subsequent calculations
+	ratio = d1 / d0;
+
+	// Normalize for integration time
+	// ms = 14 is the rounded value setTiming() gives for the nominal 13.7ms integration
+	// (322/11 of 402ms, the same scale as getLuxInt())
+	if (ms == 14)
+		scale = 322.0/11.0;
+	else
+		scale = 402.0/ms;
+	d0 *= scale;
+	d1 *= scale;
+
+	// Normalize for gain
+	if (!gain)
+	{
+		d0 *= 16;
+		d1 *= 16;
+	}
+
+	// Determine lux per datasheet equations:
+
+	if (ratio < 0.5)
+	{
+		lux = 0.0304 * d0 - 0.062 * d0 * pow(ratio,1.4);
+		return(true);
+	}
+
+	if (ratio < 0.61)
+	{
+		lux = 0.0224 * d0 - 0.031 * d1;
+		return(true);
+	}
+
+	if (ratio < 0.80)
+	{
+		lux = 0.0128 * d0 - 0.0153 * d1;
+		return(true);
+	}
+
+	if (ratio < 1.30)
+	{
+		lux = 0.00146 * d0 - 0.00112 * d1;
+		return(true);
+	}
+
+	// if (ratio > 1.30)
+	lux = 0.0;
+	return(true);
+}
+#endif
+
+#if TSL2561_WITH_INT_LUX
+// alternate int based illuminance calculation
+bool tsl2561_luxInt(bool gain, uint8_t it, uint16_t CH0, uint16_t CH1, uint32_t &lux)
+// Convert raw data to lux as integer
+// gain: gain used for the integration (false: x1, true: x16)
+// it: integration time switch used for the integration (0, 1 or 2)
+// this is not available for custom integration time
+// this function uses integer based approximate calculation, it does not use the same
+// ratio breakpoints nor the same saturation rule as getLux:float (clipping thresholds)
+// share of readings within 1% of getLux / off by more than 10% (gain x1, x16, lux >= 1):
+// 13.7ms: 56% / 14%, 101ms: 51% / 14%, 402ms: 55% / 13-14%
+// the largest errors are at low lux and near ratio 1.3, see extras/lux_sweep
+// CH0, CH1: results from getData()
+// lux will be set to illuminance value in lux
+// returns true (1) if calculation was successful
+// RETURNS false (0) AND lux = 0 IF EITHER SENSOR WAS ABOVE THE CLIPPING THRESHOLD
+{
+  unsigned long chScale;
+  unsigned long channel1;
+  unsigned long channel0;
+
+  /* Make sure the sensor isn't saturated! */
+  uint16_t clipThreshold;
+  switch (it)
+  {
+    case 0:
+      clipThreshold = TSL2561_CLIPPING_13MS;
+      break;
+    case 1:
+      clipThreshold = TSL2561_CLIPPING_101MS;
+      break;
+    default:
+      clipThreshold = TSL2561_CLIPPING_402MS;
+      break;
+  }
+
+  /* Return false and lux=0 if the sensor is saturated */
+  if ((CH0 > clipThreshold) || (CH1> clipThreshold))
+  {
+		lux = 0;
+    return false;
+  }
+
+  /* Get the correct scale depending on the intergration time */
+
+  switch (it)
+  {
+    case 0:
+      chScale = TSL2561_LUX_CHSCALE_TINT0;
+      break;
+    case 1:
+      chScale = TSL2561_LUX_CHSCALE_TINT1;
+      break;
+    default: // No scaling ... integration time = 402ms
+      chScale = (1 << TSL2561_LUX_CHSCALE);
+      break;
+  }
+
+  // Scale for gain (1x or 16x)
+  if (!gain) chScale = chScale << 4;
+
+  // scale the channel values
+  channel0 = (CH0 * chScale) >> TSL2561_LUX_CHSCALE;
+  channel1 = (CH1 * chScale) >> TSL2561_LUX_CHSCALE;
+
+  // find the ratio of the channel values (Channel1/Channel0)
+  unsigned long ratio1 = 0;
+  if (channel0 != 0) ratio1 = (channel1 << (TSL2561_LUX_RATIOSCALE+1)) / channel0;
+
+  // round the ratio value
+  unsigned long ratio = (ratio1 + 1) >> 1;
+
+  unsigned int b, m;
+
+
+  if (ratio <= TSL2561_LUX_K1T)
+  {b=TSL2561_LUX_B1T; m=TSL2561_LUX_M1T;}
+  else if (ratio <= TSL2561_LUX_K2T)
+  {b=TSL2561_LUX_B2T; m=TSL2561_LUX_M2T;}
+  else if (ratio <= TSL2561_LUX_K3T)
+  {b=TSL2561_LUX_B3T; m=TSL2561_LUX_M3T;}
+  else if (ratio <= TSL2561_LUX_K4T)
+  {b=TSL2561_LUX_B4T; m=TSL2561_LUX_M4T;}
+  else if (ratio <= TSL2561_LUX_K5T)
+  {b=TSL2561_LUX_B5T; m=TSL2561_LUX_M5T;}
+  else if (ratio <= TSL2561_LUX_K6T)
+  {b=TSL2561_LUX_B6T; m=TSL2561_LUX_M6T;}
+  else if (ratio <= TSL2561_LUX_K7T)
+  {b=TSL2561_LUX_B7T; m=TSL2561_LUX_M7T;}
+  else if (ratio > TSL2561_LUX_K8T)
+  {b=TSL2561_LUX_B8T; m=TSL2561_LUX_M8T;}
+
+  unsigned long temp;
+
+  // do not allow negative lux value (unsigned, would wrap around)
+  if ((channel1 * m) > (channel0 * b))
+    temp = 0;
+  else
+    temp = ((channel0 * b) - (channel1 * m));
+
+  // round lsb (2^(LUX_SCALE-1))
+  temp += (1 << (TSL2561_LUX_LUXSCALE-1));
+
+  // strip off fractional portion
+  lux = temp >> TSL2561_LUX_LUXSCALE;
+
+  // Signal I2C had no errors
+  return true;
+}
+#endif
@@ -0,0 +1,77 @@
+/*
+	Lux conversion for the TAOS TSL2561 Illumination Sensor.
+	This part of the library does not depend on the Particle API so it can also
+	be built on a host computer (see extras/lux_sweep).
+
+	Float based calculation from SparkFun Electronics, integer based calculation
+	from Adafruit (see tsl2561.cpp).
+*/
+
+#include <stdint.h>
+#include "tsl2561_config.h"
+
+#ifndef TSL2561_lux_h
+#define TSL2561_lux_h
+
+#if TSL2561_WITH_FLOAT_LUX
+bool tsl2561_lux(bool gain, uint16_t ms, uint16_t CH0, uint16_t CH1, double &lux);
+// Convert raw data to lux
+// gain: gain used for the integration (false: x1, true: x16)
+// ms: integration time in ms, from setTiming() or from manual integration
+// CH0, CH1: results from getData()
+// lux will be set to resulting lux calculation
+// returns true (1) if calculation was successful
+// RETURNS false (0) AND lux = 0.0 IF EITHER SENSOR WAS SATURATED (0XFFFF)
+#endif
+
+#if TSL2561_WITH_INT_LUX
+bool tsl2561_luxInt(bool gain, uint8_t it, uint16_t CH0, uint16_t CH1, uint32_t &lux);
+// Convert raw data to lux as integer
+// gain: gain used for the integration (false: x1, true: x16)
+// it: integration time switch used for the integration (0, 1 or 2, see setTiming())
+// CH0, CH1: results from getData()
+// lux will be set to illuminance value in lux
+// returns true (1) if calculation was successful
+// RETURNS false (0) AND lux = 0 IF EITHER SENSOR WAS ABOVE THE CLIPPING THRESHOLD
+#endif
+
+// Int based illuminance calculation
+// T, FN and CL package values
+#define TSL2561_LUX_K1T           (0x0040)  // 0.125 * 2^RATIO_SCALE
+#define TSL2561_LUX_B1T           (0x01f2)  // 0.0304 * 2^LUX_SCALE
+#define TSL2561_LUX_M1T           (0x01be)  // 0.0272 * 2^LUX_SCALE
+#define TSL2561_LUX_K2T           (0x0080)  // 0.250 * 2^RATIO_SCALE
+#define TSL2561_LUX_B2T           (0x0214)  // 0.0325 * 2^LUX_SCALE
+#define TSL2561_LUX_M2T           (0x02d1)  // 0.0440 * 2^LUX_SCALE
+#define TSL2561_LUX_K3T           (0x00c0)  // 0.375 * 2^RATIO_SCALE
+#define TSL2561_LUX_B3T           (0x023f)  // 0.0351 * 2^LUX_SCALE
+#define TSL2561_LUX_M3T           (0x037b)  // 0.0544 * 2^LUX_SCALE
+#define TSL2561_LUX_K4T           (0x0100)  // 0.50 * 2^RATIO_SCALE
+#define TSL2561_LUX_B4T           (0x0270)  // 0.0381 * 2^LUX_SCALE
+#define TSL2561_LUX_M4T           (0x03fe)  // 0.0624 * 2^LUX_SCALE
+#define TSL2561_LUX_K5T           (0x0138)  // 0.61 * 2^RATIO_SCALE
+#define TSL2561_LUX_B5T           (0x016f)  // 0.0224 * 2^LUX_SCALE
+#define TSL2561_LUX_M5T           (0x01fc)  // 0.0310 * 2^LUX_SCALE
+#define TSL2561_LUX_K6T           (0x019a)  // 0.80 * 2^RATIO_SCALE
+#define TSL2561_LUX_B6T           (0x00d2)  // 0.0128 * 2^LUX_SCALE
+#define TSL2561_LUX_M6T           (0x00fb)  // 0.0153 * 2^LUX_SCALE
+#define TSL2561_LUX_K7T           (0x029a)  // 1.3 * 2^RATIO_SCALE
+#define TSL2561_LUX_B7T           (0x0018)  // 0.00146 * 2^LUX_SCALE
+#define TSL2561_LUX_M7T           (0x0012)  // 0.00112 * 2^LUX_SCALE
+#define TSL2561_LUX_K8T           (0x029a)  // 1.3 * 2^RATIO_SCALE
+#define TSL2561_LUX_B8T           (0x0000)  // 0.000 * 2^LUX_SCALE
+#define TSL2561_LUX_M8T           (0x0000)  // 0.000 * 2^LUX_SCALE
+
+// Clipping thresholds
+#define TSL2561_CLIPPING_13MS     (4900)
+#define TSL2561_CLIPPING_101MS    (37000)
+#define TSL2561_CLIPPING_402MS    (65000)
+// scale cofficients
+#define TSL2561_LUX_LUXSCALE      (14)      // Scale by 2^14
+#define TSL2561_LUX_RATIOSCALE    (9)       // Scale ratio by 2^9
+#define TSL2561_LUX_CHSCALE       (10)      // Scale channel values by 2^10
+#define TSL2561_LUX_CHSCALE_TINT0 (0x7517)  // 322/11 * 2^TSL2561_LUX_CHSCALE
+#define TSL2561_LUX_CHSCALE_TINT1 (0x0FE7)  // 322/81 * 2^TSL2561_LUX_CHSCALE
+
+
+#endif
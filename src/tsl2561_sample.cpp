@@ -0,0 +1,66 @@
+/*
+	Raw sample record for the TAOS TSL2561 Illumination Sensor.
+	Lux values are calculated with the settings stored in the record, not with
+	the current settings of the driver, so setTiming() after capture is harmless.
+*/
+
+#include "tsl2561_sample.h"
+#include "tsl2561_lux.h"
+
+
+TSL2561Sample::TSL2561Sample(void){
+	set(0,0,false,1,101);
+}
+
+
+void TSL2561Sample::set(uint16_t CH0, uint16_t CH1, bool gain, uint8_t it, uint16_t ms)
+	// Store a new raw sample, forget previously calculated lux values
+{
+	_CH0 = CH0;
+	_CH1 = CH1;
+	_gain = gain;
+	_it = it;
+	_ms = ms;
+	_cached = 0;
+}
+
+#if TSL2561_WITH_FLOAT_LUX
+bool TSL2561Sample::getLux(double &lux)
+	// Lux value of this sample, calculated on first call only
+	// returns true (1) if calculation was successful
+	// RETURNS false (0) AND lux = 0.0 IF EITHER SENSOR WAS SATURATED (0XFFFF) OR ms = 0
+{
+	if (!(_cached & TSL2561_SAMPLE_LUX))
+	{
+		if ((_ms != 0) && tsl2561_lux(_gain,_ms,_CH0,_CH1,_lux))
+			_cached |= TSL2561_SAMPLE_LUX_OK;
+		else
+			_lux = 0.0;
+		_cached |= TSL2561_SAMPLE_LUX;
+	}
+
+	lux = _lux;
+	return(_cached & TSL2561_SAMPLE_LUX_OK);
+}
+#endif
+
+#if TSL2561_WITH_INT_LUX
+bool TSL2561Sample::getLuxInt(uint32_t &lux)
+	// Lux value of this sample as integer, calculated on first call only
+	// returns true (1) if calculation was successful
+	// RETURNS false (0) AND lux = 0 IF EITHER SENSOR WAS ABOVE THE CLIPPING THRESHOLD
+	// OR FOR A MANUAL INTEGRATION (it = 3)
+{
+	if (!(_cached & TSL2561_SAMPLE_LUXINT))
+	{
+		if ((_it < 3) && tsl2561_luxInt(_gain,_it,_CH0,_CH1,_luxInt))
+			_cached |= TSL2561_SAMPLE_LUXINT_OK;
+		else
+			_luxInt = 0;
+		_cached |= TSL2561_SAMPLE_LUXINT;
+	}
+
+	lux = _luxInt;
+	return(_cached & TSL2561_SAMPLE_LUXINT_OK);
+}
+#endif
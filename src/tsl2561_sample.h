@@ -0,0 +1,85 @@
+/*
+	Raw sample record for the TAOS TSL2561 Illumination Sensor.
+	Keeps CH0/CH1 with the gain and integration time used to capture them, lux
+	values are only calculated when first asked for and then kept.
+	This part of the library does not depend on the Particle API.
+*/
+
+#include <stdint.h>
+#include "tsl2561_config.h"
+
+#ifndef TSL2561_sample_h
+#define TSL2561_sample_h
+
+// The record layout depends on the profile: the class is put in a namespace named after
+// the layout, so an application built with another profile than the library fails to
+// link (undefined reference to tsl2561_layout_...::TSL2561Sample) instead of sharing
+// records of different sizes. The namespace is inline: the class is still TSL2561Sample.
+#if TSL2561_WITH_FLOAT_LUX && TSL2561_WITH_INT_LUX
+#define TSL2561_SAMPLE_LAYOUT     tsl2561_layout_float_int
+#elif TSL2561_WITH_FLOAT_LUX
+#define TSL2561_SAMPLE_LAYOUT     tsl2561_layout_float
+#elif TSL2561_WITH_INT_LUX
+#define TSL2561_SAMPLE_LAYOUT     tsl2561_layout_int
+#else
+#define TSL2561_SAMPLE_LAYOUT     tsl2561_layout_raw
+#endif
+
+inline namespace TSL2561_SAMPLE_LAYOUT {
+
+class TSL2561Sample
+{
+
+	public:
+
+	uint16_t _CH0;
+	uint16_t _CH1;
+	bool _gain;
+	uint8_t _it;
+	uint16_t _ms;
+	uint8_t _cached;
+#if TSL2561_WITH_FLOAT_LUX
+	double _lux;
+#endif
+#if TSL2561_WITH_INT_LUX
+	uint32_t _luxInt;
+#endif
+
+	public:
+		TSL2561Sample(void);
+		// Empty sample record (CH0 = CH1 = 0)
+
+		void set(uint16_t CH0, uint16_t CH1, bool gain, uint8_t it, uint16_t ms);
+		// Store a new raw sample, forget previously calculated lux values
+		// CH0, CH1: results from getData()
+		// gain, it: gain and integration time switch used for the integration (see setTiming())
+		// ms: integration time in ms, from setTiming() or from manual integration
+
+#if TSL2561_WITH_FLOAT_LUX
+		bool getLux(double &lux);
+		// Lux value of this sample, calculated on first call only
+		// lux will be set to resulting lux calculation
+		// returns true (1) if calculation was successful
+		// RETURNS false (0) AND lux = 0.0 IF EITHER SENSOR WAS SATURATED (0XFFFF) OR ms = 0
+#endif
+
+#if TSL2561_WITH_INT_LUX
+		bool getLuxInt(uint32_t &lux);
+		// Lux value of this sample as integer, calculated on first call only
+		// lux will be set to illuminance value in lux
+		// returns true (1) if calculation was successful
+		// RETURNS false (0) AND lux = 0 IF EITHER SENSOR WAS ABOVE THE CLIPPING THRESHOLD
+		// OR FOR A MANUAL INTEGRATION (it = 3)
+#endif
+};
+
+}
+
+// _cached flags
+#define TSL2561_SAMPLE_LUX        (0x01)    // _lux calculated
+#define TSL2561_SAMPLE_LUX_OK     (0x02)    // _lux is valid
+#define TSL2561_SAMPLE_LUXINT     (0x04)    // _luxInt calculated
+#define TSL2561_SAMPLE_LUXINT_OK  (0x08)    // _luxInt is valid
+
+
+#endif